@@ -25,10 +25,12 @@
  *******************************************************************************/
 #include "include_inliner.hpp"
 #include <algorithm>
+#include <cstdint>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <set>
 #include <sstream>
 #include <string>
 
@@ -43,6 +45,9 @@ void Bin2Hex(std::istream& source,
     std::unique_ptr<unsigned char[]> buffer(new unsigned char[bufferSize]);
     std::streamoff sourceSize = source.tellg();
     std::streamoff blockStart = 0;
+    // FNV-1a of the (inlined) content. Lets the library tell apart versions of a source
+    // without hashing the text at run time.
+    std::uint64_t hash = 0xcbf29ce484222325ull;
 
     if(variable.length() != 0)
     {
@@ -70,7 +75,10 @@ void Bin2Hex(std::istream& source,
             size_t end = std::min<size_t>(i + lineSize, blockSize);
 
             for(; j < end; j++)
+            {
                 target << "0x" << std::setw(2) << static_cast<unsigned>(buffer[j]) << ",";
+                hash = (hash ^ buffer[j]) * 0x100000001b3ull;
+            }
 
             target << std::endl;
             i = end;
@@ -85,7 +93,12 @@ void Bin2Hex(std::istream& source,
     if(variable.length() != 0)
     {
         target << "};" << std::endl;
+        target << "extern const unsigned long long " << variable << "_HASH;" << std::endl;
+        target << "const unsigned long long " << variable << "_HASH = 0x" << std::setw(16)
+               << hash << "ull;" << std::endl;
     }
+
+    target << std::setbase(10);
 }
 
 void PrintHelp()
@@ -106,6 +119,12 @@ void PrintHelp()
     std::cout << "           -m[ark-includes] : mark variables that represent include files with "
                  "'__INC'. Default: off"
               << std::endl;
+    std::cout << "           -c[ache] <path>: directory to keep inlined sources in, an entry is "
+                 "reused while the sources it was built from are unchanged. Default: no cache"
+              << std::endl;
+    std::cout << "           -d[epfile] <path>: write a make-style dependency file listing all the "
+                 "inlined files. Requires -target. Default: off"
+              << std::endl;
 }
 
 [[gnu::noreturn]] void WrongUsage(const std::string& error)
@@ -130,7 +149,10 @@ void Process(const std::string& sourcePath,
              size_t lineSize,
              bool recurse,
              bool as_extern,
-             bool mark_includes)
+             bool mark_includes,
+             IncludeInliner& inliner,
+             const InlinerCache& cache,
+             std::set<std::string>& dependencies)
 {
     std::string fileName(sourcePath);
     std::string extension, root;
@@ -168,28 +190,42 @@ void Process(const std::string& sourcePath,
 
     if(is_asm || is_cl || is_hip || is_header)
     {
-        IncludeInliner inliner;
+        const auto key = PathHelpers::GetAbsolutePath(sourcePath) + "|" + root + "|" + extension + (recurse ? "|r" : "");
+        std::string cached;
+        std::set<std::string> inlined;
 
-        try
+        if(cache.Load(key, cached, inlined))
         {
-            if(is_asm)
-                inliner.Process(
-                    sourceFile, inlinerTemp, root, sourcePath, ".include", false, recurse);
-            else if(is_cl || is_header)
-                inliner.Process(
-                    sourceFile, inlinerTemp, root, sourcePath, "#include", true, recurse);
-            else if(is_hip)
-                inliner.Process(
-                    sourceFile, inlinerTemp, root, sourcePath, "<#not_include>", true, false);
+            inlinerTemp << cached;
         }
-        catch(const InlineException& ex)
+        else
         {
-            std::cerr << ex.What() << std::endl;
-            std::cerr << ex.GetTrace() << std::endl;
-            // NOLINTNEXTLINE (concurrency-mt-unsafe)
-            std::exit(1);
+            try
+            {
+                if(is_asm)
+                    inliner.Process(
+                        sourceFile, inlinerTemp, root, sourcePath, ".include", false, recurse);
+                else if(is_cl || is_header)
+                    inliner.Process(
+                        sourceFile, inlinerTemp, root, sourcePath, "#include", true, recurse);
+                else if(is_hip)
+                    inliner.Process(
+                        sourceFile, inlinerTemp, root, sourcePath, "<#not_include>", true, false);
+            }
+            catch(const InlineException& ex)
+            {
+                std::cerr << ex.What() << std::endl;
+                std::cerr << ex.GetTrace() << std::endl;
+                // NOLINTNEXTLINE (concurrency-mt-unsafe)
+                std::exit(1);
+            }
+
+            inlined = inliner.GetDependencies();
+            inlined.insert(PathHelpers::GetAbsolutePath(sourcePath));
+            cache.Store(key, inlined, inlinerTemp.str());
         }
 
+        dependencies.insert(inlined.begin(), inlined.end());
         source = &inlinerTemp;
     }
 
@@ -206,6 +242,31 @@ void Process(const std::string& sourcePath,
     Bin2Hex(*source, target, variable, true, bufferSize, lineSize);
 }
 
+void WriteDepfile(const std::string& path,
+                  const std::string& target,
+                  const std::set<std::string>& dependencies)
+{
+    if(target.empty())
+        WrongUsage("depfile requires target");
+
+    const auto escape = [](const std::string& file) {
+        std::string escaped;
+        for(const auto c : file)
+        {
+            if(c == ' ' || c == '#')
+                escaped += '\\';
+            escaped += c;
+        }
+        return escaped;
+    };
+
+    std::ofstream depfile(path, std::ios::out);
+    depfile << escape(target) << ":";
+    for(const auto& dependency : dependencies)
+        depfile << " \\" << std::endl << "  " << escape(dependency);
+    depfile << std::endl;
+}
+
 int main(int argsn, char** args)
 {
     if(argsn == 1)
@@ -223,6 +284,9 @@ int main(int argsn, char** args)
     bool recurse         = true;
     bool as_extern       = false;
     bool mark_includes   = false;
+    std::string targetPath;
+    std::string depfilePath;
+    std::string cacheDir;
 
     int i = 0;
     while(++i < argsn && **args != '-')
@@ -241,9 +305,23 @@ int main(int argsn, char** args)
             *target << "#ifndef MIOPEN_USE_CLANG_TIDY" << std::endl;
             *target << "#include <cstddef>" << std::endl;
 
+            // Shared by all the sources, so that common includes are expanded only once.
+            IncludeInliner inliner;
+            const InlinerCache cache{cacheDir};
+            std::set<std::string> dependencies;
+
             while(++i < argsn)
             {
-                Process(args[i], *target, bufferSize, lineSize, recurse, as_extern, mark_includes);
+                Process(args[i],
+                        *target,
+                        bufferSize,
+                        lineSize,
+                        recurse,
+                        as_extern,
+                        mark_includes,
+                        inliner,
+                        cache,
+                        dependencies);
             }
 
             *target << "#endif" << std::endl;
@@ -253,11 +331,15 @@ int main(int argsn, char** args)
                 *target << "#endif" << std::endl;
             }
 
+            if(!depfilePath.empty())
+                WriteDepfile(depfilePath, targetPath, dependencies);
+
             return 0;
         }
         else if(arg == "t" || arg == "target")
         {
-            targetFile.open(args[++i], std::ios::out);
+            targetPath = args[++i];
+            targetFile.open(targetPath, std::ios::out);
             target = &targetFile;
         }
         else if(arg == "l" || arg == "line-size")
@@ -272,6 +354,10 @@ int main(int argsn, char** args)
             mark_includes = true;
         else if(arg == "e" || arg == "extern")
             as_extern = true;
+        else if(arg == "c" || arg == "cache")
+            cacheDir = args[++i];
+        else if(arg == "d" || arg == "depfile")
+            depfilePath = args[++i];
         else
             UnknownArgument(arg);
     }
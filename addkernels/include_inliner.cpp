@@ -24,6 +24,8 @@
  *
  *******************************************************************************/
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
 #include <exception>
 #include <fstream>
 #include <sstream>
@@ -48,7 +50,7 @@ static int GetMaxPath()
 #endif
 }
 
-static std::string GetAbsolutePath(const std::string& path)
+std::string GetAbsolutePath(const std::string& path)
 {
     std::string result(GetMaxPath(), ' ');
 #ifdef _WIN32
@@ -56,11 +58,13 @@ static std::string GetAbsolutePath(const std::string& path)
 
     if(retval == 0)
         return "";
+    result.resize(retval);
 #else
     auto* const retval = realpath(path.c_str(), &result[0]);
 
     if(retval == nullptr)
         return "";
+    result.resize(std::strlen(retval));
 #endif
     return result;
 }
@@ -82,11 +86,21 @@ void IncludeInliner::Process(std::istream& input,
                              bool allow_angle_brackets,
                              bool recurse)
 {
-    ProcessCore(input, output, root, file_name, 0, directive, allow_angle_brackets, recurse);
+    Expansion expansion;
+    ProcessCore(input, expansion, root, file_name, 0, directive, allow_angle_brackets, recurse);
+    _dependencies = std::move(expansion.dependencies);
+
+    for(const auto& line : expansion.lines)
+    {
+        if(output.tellp() > 0)
+            output << std::endl;
+
+        output << line;
+    }
 }
 
 void IncludeInliner::ProcessCore(std::istream& input,
-                                 std::ostream& output,
+                                 Expansion& output,
                                  const std::string& root,
                                  const std::string& file_name,
                                  int line_number,
@@ -161,30 +175,44 @@ void IncludeInliner::ProcessCore(std::istream& input,
                 throw IncludeNotFoundException(include_file_path,
                                                GetIncludeStackTrace(current_line));
             }
-            std::ifstream include_file(abs_include_file_path, std::ios::in);
-
-            if(!include_file.good())
-                throw IncludeCantBeOpenedException(include_file_path,
-                                                   GetIncludeStackTrace(current_line));
-
-            ProcessCore(include_file,
-                        output,
-                        root,
-                        include_file_path,
-                        current_line,
-                        directive,
-                        allow_angle_brackets,
-                        recurse);
+
+            // Files like the Winograd *.inc are shared by many sources, expand them only once.
+            const auto key = root + '\n' + abs_include_file_path + '\n' + directive +
+                             (allow_angle_brackets ? "<>" : "") + (recurse ? "r" : "");
+            auto cached = _expansions.find(key);
+
+            if(cached == _expansions.end())
+            {
+                std::ifstream include_file(abs_include_file_path, std::ios::in);
+
+                if(!include_file.good())
+                    throw IncludeCantBeOpenedException(include_file_path,
+                                                       GetIncludeStackTrace(current_line));
+
+                Expansion expansion;
+                expansion.dependencies.insert(abs_include_file_path);
+                ProcessCore(include_file,
+                            expansion,
+                            root,
+                            include_file_path,
+                            current_line,
+                            directive,
+                            allow_angle_brackets,
+                            recurse);
+                cached = _expansions.emplace(key, std::move(expansion)).first;
+            }
+
+            output.lines.insert(
+                output.lines.end(), cached->second.lines.begin(), cached->second.lines.end());
+            output.dependencies.insert(cached->second.dependencies.begin(),
+                                       cached->second.dependencies.end());
         }
         else
         {
             if(include_optional)
                 throw IncludeExpectedException(GetIncludeStackTrace(current_line));
 
-            if(output.tellp() > 0)
-                output << std::endl;
-
-            output << line;
+            output.lines.push_back(std::move(line));
         }
     }
 
@@ -211,3 +239,104 @@ std::string IncludeInliner::GetIncludeStackTrace(int line)
 
     return ss.str();
 }
+
+std::uint64_t InlinerCache::Hash(const std::string& data, std::uint64_t hash)
+{
+    // FNV-1a, the same one addkernels uses for the content hashes of the embedded sources.
+    for(const auto c : data)
+        hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+    return hash;
+}
+
+bool InlinerCache::HashFile(const std::string& path, std::uint64_t& hash)
+{
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if(!file.good())
+        return false;
+    std::ostringstream content;
+    content << file.rdbuf();
+    hash = Hash(content.str());
+    return true;
+}
+
+std::string InlinerCache::GetPath(const std::string& key) const
+{
+    std::ostringstream ss;
+    ss << directory << "/" << std::hex << Hash(key) << ".inl";
+    return ss.str();
+}
+
+// File format:
+//   <key>
+//   <number of dependencies>
+//   <content hash> <absolute path>   (one line per dependency)
+//   <inlined source>
+bool InlinerCache::Load(const std::string& key,
+                        std::string& content,
+                        std::set<std::string>& dependencies) const
+{
+    if(directory.empty())
+        return false;
+
+    std::ifstream file(GetPath(key), std::ios::in | std::ios::binary);
+    if(!file.good())
+        return false;
+
+    std::string stored_key;
+    std::getline(file, stored_key);
+    if(stored_key != key)
+        return false;
+
+    std::string line;
+    std::getline(file, line);
+    const auto count = std::stoul(line);
+
+    for(auto i = 0ul; i < count; ++i)
+    {
+        std::getline(file, line);
+        const auto space = line.find(' ');
+        if(space == std::string::npos)
+            return false;
+
+        const auto path = line.substr(space + 1);
+        std::uint64_t hash;
+        if(!HashFile(path, hash) || std::stoull(line.substr(0, space), nullptr, 16) != hash)
+            return false;
+        dependencies.insert(path);
+    }
+
+    std::ostringstream ss;
+    ss << file.rdbuf();
+    content = ss.str();
+    return true;
+}
+
+void InlinerCache::Store(const std::string& key,
+                         const std::set<std::string>& dependencies,
+                         const std::string& content) const
+{
+    if(directory.empty())
+        return;
+
+    std::ostringstream ss;
+    ss << key << std::endl << dependencies.size() << std::endl;
+    for(const auto& dependency : dependencies)
+    {
+        std::uint64_t hash;
+        if(!HashFile(dependency, hash))
+            return;
+        ss << std::hex << hash << std::dec << " " << dependency << std::endl;
+    }
+    ss << content;
+
+    // Write to a temporary file first, parallel builds may read the entry meanwhile.
+    const auto path = GetPath(key);
+    const auto tmp  = path + ".tmp";
+    {
+        std::ofstream file(tmp, std::ios::out | std::ios::binary);
+        file << ss.str();
+        if(!file.good())
+            return;
+    }
+    std::rename(tmp.c_str(), path.c_str());
+}
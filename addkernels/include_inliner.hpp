@@ -27,9 +27,18 @@
 
 #define SOURCE_INLINER_HPP
 #include "source_file_desc.hpp"
+#include <cstdint>
+#include <map>
 #include <ostream>
 #include <memory>
+#include <set>
 #include <stack>
+#include <vector>
+
+namespace PathHelpers {
+/// Returns an empty string if the file does not exist.
+std::string GetAbsolutePath(const std::string& path);
+} // namespace PathHelpers
 
 class InlineException : public std::exception
 {
@@ -125,12 +134,25 @@ class IncludeInliner
                  bool recurse);
     std::string GetIncludeStackTrace(int line);
 
+    /// Absolute paths of all the files inlined by the last Process() call.
+    const std::set<std::string>& GetDependencies() const { return _dependencies; }
+
     private:
+    /// Fully expanded include file. Expansion depends only on the file content, the root
+    /// directory the nested includes are resolved against and the directive options.
+    struct Expansion
+    {
+        std::vector<std::string> lines;
+        std::set<std::string> dependencies;
+    };
+
     int _include_depth                                   = 0;
     std::shared_ptr<SourceFileDesc> _included_stack_head = nullptr;
+    std::map<std::string, Expansion> _expansions;
+    std::set<std::string> _dependencies;
 
     void ProcessCore(std::istream& input,
-                     std::ostream& output,
+                     Expansion& output,
                      const std::string& root,
                      const std::string& file_name,
                      int line_number,
@@ -139,4 +161,29 @@ class IncludeInliner
                      bool recurse);
 };
 
+/// Persistent cache of the inlined sources. An entry is reused when the content hashes of
+/// the source and of all its (recursive) includes match the ones recorded with the entry.
+/// Keys must not contain line breaks.
+class InlinerCache
+{
+    public:
+    InlinerCache(const std::string& directory_) : directory(directory_) {}
+
+    bool Load(const std::string& key,
+              std::string& content,
+              std::set<std::string>& dependencies) const;
+    void Store(const std::string& key,
+               const std::set<std::string>& dependencies,
+               const std::string& content) const;
+
+    static std::uint64_t Hash(const std::string& data,
+                              std::uint64_t hash = 0xcbf29ce484222325ull);
+    static bool HashFile(const std::string& path, std::uint64_t& hash);
+
+    private:
+    std::string directory;
+
+    std::string GetPath(const std::string& key) const;
+};
+
 #endif // !SOURCE_INLINER_HPP
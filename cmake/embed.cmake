@@ -112,6 +112,8 @@ function(embed_file OUTPUT_FILE OUTPUT_SYMBOL FILE)
             OUTPUT "${FILE}.o"
             COMMAND ${EMBED_LD} -r -o "${FILE}.o" -z noexecstack --format=binary "${REL_FILE}" 
             COMMAND ${EMBED_OBJCOPY} --rename-section .data=.rodata,alloc,load,readonly,data,contents "${FILE}.o"
+            # Page aligned, so that the embedded SQLite databases can be served without copying
+            COMMAND ${EMBED_OBJCOPY} --set-section-alignment .rodata=4096 "${FILE}.o"
             WORKING_DIRECTORY ${WORKING_DIRECTORY}
             DEPENDS ${FILE}
             VERBATIM
@@ -0,0 +1,122 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/md5.hpp>
+#include <miopen/xxhash.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace hash {
+
+using Clock = std::chrono::steady_clock;
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(sizes, "sizes");
+        add(bytes, "bytes");
+        add(chunk, "chunk");
+    }
+
+    void run()
+    {
+        std::mt19937 rng{42};
+        std::uniform_int_distribution<int> dist{32, 126};
+
+        for(const auto size : sizes)
+        {
+            std::string input(size, ' ');
+            for(auto& c : input)
+                c = static_cast<char>(dist(rng));
+
+            const auto repeats = std::max<std::size_t>(1, bytes / std::max<std::size_t>(1, size));
+
+            Measure("md5", input, repeats, [](const std::string& s) {
+                return std::hash<std::string>{}(md5(s));
+            });
+            Measure("md5 streaming", input, repeats, [this](const std::string& s) {
+                Md5Hasher hasher;
+                for(std::size_t i = 0; i < s.size(); i += chunk)
+                    hasher.Update(s.data() + i, std::min(chunk, s.size() - i));
+                return std::hash<std::string>{}(hasher.Finalize());
+            });
+            Measure("xxhash64", input, repeats, [](const std::string& s) {
+                return static_cast<std::size_t>(xxhash64(s));
+            });
+            Measure("xxhash64 streaming", input, repeats, [this](const std::string& s) {
+                XxHash64 hasher;
+                for(std::size_t i = 0; i < s.size(); i += chunk)
+                    hasher.Update(s.data() + i, std::min(chunk, s.size() - i));
+                return static_cast<std::size_t>(hasher.Finalize());
+            });
+            Measure("std::hash", input, repeats, [](const std::string& s) {
+                return std::hash<std::string>{}(s);
+            });
+        }
+    }
+
+    private:
+    std::vector<std::size_t> sizes = {16, 256, 4096, 65536, 1048576};
+    std::size_t bytes              = 256 * 1024 * 1024;
+    std::size_t chunk              = 64;
+
+    template <class F>
+    static void
+    Measure(const std::string& name, const std::string& input, std::size_t repeats, F hash)
+    {
+        std::size_t sink = 0;
+        const auto start = Clock::now();
+        for(std::size_t i = 0; i < repeats; ++i)
+            sink ^= hash(input);
+        const auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+        const auto total = static_cast<double>(input.size()) * repeats;
+        std::cout << std::setw(20) << std::left << name << " size " << std::setw(8)
+                  << input.size() << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(10) << total / elapsed / (1024 * 1024) << " MiB/s"
+                  << std::setw(10) << elapsed * 1e9 / repeats << " ns/op"
+                  << " (" << (sink & 1) << ")" << std::endl;
+    }
+};
+
+} // namespace hash
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::hash::SpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,256 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/config.h>
+#include <miopen/temp_file.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#if MIOPEN_ENABLE_SQLITE
+#include <sqlite3.h>
+
+extern "C" {
+int miopen_sqlite3_memvfs_init(sqlite3* db, char** pzErrMsg, const sqlite3_api_routines* pApi);
+}
+
+namespace miopen {
+namespace sqlite_memvfs {
+
+using Clock = std::chrono::steady_clock;
+
+inline double Ms(Clock::duration d)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count() * 1e-6;
+}
+
+inline void Check(int rc, sqlite3* db, const std::string& what)
+{
+    if(rc == SQLITE_OK || rc == SQLITE_DONE || rc == SQLITE_ROW)
+        return;
+    std::cerr << what << ": " << (db != nullptr ? sqlite3_errmsg(db) : sqlite3_errstr(rc))
+              << std::endl;
+    std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+}
+
+inline std::string ConfigKey(int i)
+{
+    // Resembles the perf-db config keys in size and distribution.
+    return std::to_string(64 + i % 512) + "-" + std::to_string(7 + i % 56) + "-" +
+           std::to_string(7 + i % 56) + "-3x3-" + std::to_string(i) + "-NCHW-FP32-F";
+}
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(records, "records");
+        add(lookups, "lookups");
+        add(iterations, "iterations");
+    }
+
+    void run()
+    {
+        TempFile file{"miopen-speedtest-memvfs"};
+        CreateDb(file.Path());
+        const auto blob = LoadAligned(file.Path());
+        RegisterMemVfs();
+
+        std::cout << "records: " << records << ", lookups: " << lookups
+                  << ", db size: " << blob.size << " bytes" << std::endl;
+
+        const auto file_open = [&]() {
+            sqlite3* db = nullptr;
+            Check(sqlite3_open_v2(file.Path().c_str(), &db, SQLITE_OPEN_READONLY, nullptr),
+                  db,
+                  "open file");
+            return db;
+        };
+
+        const auto memvfs_open = [&](bool readonly) {
+            return [&blob, readonly]() {
+                sqlite3* db = nullptr;
+                char* uri   = sqlite3_mprintf("file:ignoredFilename?ptr=0x%p&sz=%lld%s",
+                                            blob.data,
+                                            static_cast<long long>(blob.size),
+                                            readonly ? "&readonly=1" : "");
+                const auto flags =
+                    (readonly ? SQLITE_OPEN_READONLY : SQLITE_OPEN_READWRITE) | SQLITE_OPEN_URI;
+                const auto rc = sqlite3_open_v2(uri, &db, flags, "memvfs");
+                sqlite3_free(uri);
+                Check(rc, db, "open memvfs");
+                if(readonly)
+                    Exec(db, "PRAGMA mmap_size=" + std::to_string(blob.size) + ";");
+                return db;
+            };
+        };
+
+        Measure("file", file_open);
+        Measure("memvfs", memvfs_open(false));
+        Measure("memvfs readonly", memvfs_open(true));
+    }
+
+    private:
+    int records    = 100000;
+    int lookups    = 100000;
+    int iterations = 5;
+
+    struct AlignedBlob
+    {
+        std::unique_ptr<char[]> storage;
+        char* data       = nullptr;
+        std::size_t size = 0;
+    };
+
+    static void Exec(sqlite3* db, const std::string& query)
+    {
+        Check(sqlite3_exec(db, query.c_str(), nullptr, nullptr, nullptr), db, query);
+    }
+
+    static void RegisterMemVfs()
+    {
+        const auto init = reinterpret_cast<void (*)(void)>(miopen_sqlite3_memvfs_init);
+        sqlite3_auto_extension(init);
+        sqlite3* db = nullptr;
+        Check(sqlite3_open(":memory:", &db), db, "open :memory:");
+        sqlite3_close(db);
+        sqlite3_cancel_auto_extension(init);
+    }
+
+    void CreateDb(const std::string& path) const
+    {
+        sqlite3* db = nullptr;
+        Check(sqlite3_open(path.c_str(), &db), db, "create");
+        Exec(db,
+             "CREATE TABLE perf_db (id INTEGER PRIMARY KEY ASC, solver TEXT NOT NULL, "
+             "config TEXT NOT NULL, params TEXT NOT NULL);"
+             "CREATE UNIQUE INDEX idx_perf_db ON perf_db(solver, config);"
+             "BEGIN;");
+
+        sqlite3_stmt* stmt = nullptr;
+        const auto insert = "INSERT INTO perf_db(solver, config, params) VALUES(?, ?, ?);";
+        Check(sqlite3_prepare_v2(db, insert, -1, &stmt, nullptr), db, "prepare insert");
+        for(auto i = 0; i < records; ++i)
+        {
+            const auto config = ConfigKey(i);
+            const auto params = std::to_string(i % 16) + "," + std::to_string(i % 8) + ",1,4,16";
+            sqlite3_bind_text(stmt, 1, "ConvAsm1x1U", -1, SQLITE_STATIC);   // NOLINT
+            sqlite3_bind_text(stmt, 2, config.c_str(), -1, SQLITE_TRANSIENT); // NOLINT
+            sqlite3_bind_text(stmt, 3, params.c_str(), -1, SQLITE_TRANSIENT); // NOLINT
+            Check(sqlite3_step(stmt), db, "insert");
+            sqlite3_reset(stmt);
+        }
+        sqlite3_finalize(stmt);
+        Exec(db, "COMMIT;");
+        sqlite3_close(db);
+    }
+
+    static AlignedBlob LoadAligned(const std::string& path)
+    {
+        constexpr std::size_t page = 4096;
+        std::ifstream in(path, std::ios::binary);
+        const std::vector<char> content{std::istreambuf_iterator<char>(in),
+                                        std::istreambuf_iterator<char>()};
+        AlignedBlob blob;
+        blob.size    = content.size();
+        blob.storage = std::make_unique<char[]>(blob.size + page);
+        const auto addr = reinterpret_cast<std::uintptr_t>(blob.storage.get());
+        blob.data       = blob.storage.get() + (page - addr % page) % page;
+        std::copy(content.begin(), content.end(), blob.data);
+        return blob;
+    }
+
+    template <class TOpen>
+    void Measure(const std::string& name, const TOpen& open) const
+    {
+        auto open_time   = 0.;
+        auto lookup_time = 0.;
+        auto found       = 0;
+        std::mt19937 gen(17);
+        std::uniform_int_distribution<int> dist(0, records - 1);
+
+        for(auto it = 0; it < iterations; ++it)
+        {
+            const auto open_start = Clock::now();
+            auto db               = open();
+            sqlite3_stmt* stmt    = nullptr;
+            Check(sqlite3_prepare_v2(db,
+                                     "SELECT params FROM perf_db WHERE solver = ? AND config = ?;",
+                                     -1,
+                                     &stmt,
+                                     nullptr),
+                  db,
+                  "prepare select");
+            const auto lookup_start = Clock::now();
+            open_time += Ms(lookup_start - open_start);
+
+            for(auto i = 0; i < lookups; ++i)
+            {
+                const auto config = ConfigKey(dist(gen));
+                sqlite3_bind_text(stmt, 1, "ConvAsm1x1U", -1, SQLITE_STATIC);   // NOLINT
+                sqlite3_bind_text(stmt, 2, config.c_str(), -1, SQLITE_TRANSIENT); // NOLINT
+                if(sqlite3_step(stmt) == SQLITE_ROW)
+                    ++found;
+                sqlite3_reset(stmt);
+            }
+
+            lookup_time += Ms(Clock::now() - lookup_start);
+            sqlite3_finalize(stmt);
+            sqlite3_close(db);
+        }
+
+        if(found != lookups * iterations)
+        {
+            std::cerr << name << ": " << found << " of " << lookups * iterations
+                      << " records found" << std::endl;
+            std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+        }
+
+        std::cout << name << ": open " << open_time / iterations << " ms, lookup "
+                  << lookup_time * 1e3 / (static_cast<double>(lookups) * iterations)
+                  << " us/op" << std::endl;
+    }
+};
+
+} // namespace sqlite_memvfs
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::sqlite_memvfs::SpeedTestDriver>(argc, argv);
+    return 0;
+}
+#else
+int main() { std::cout << "SQLite is disabled, nothing to measure." << std::endl; }
+#endif
@@ -27,6 +27,7 @@
 #include <miopen/binary_cache.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/md5.hpp>
+#include <miopen/xxhash.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/env.hpp>
 #include <miopen/stringutils.hpp>
@@ -41,6 +42,8 @@
 #include <boost/filesystem.hpp>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <mutex>
 
 namespace miopen {
 
@@ -129,13 +132,36 @@ KDb GetDb(const TargetProperties& target, size_t num_cu)
 }
 #endif
 
+/// Kernel sources are hashed every time a program is looked up, so the md5 of each
+/// source is memoized. The memo is keyed by the cheap xxhash64 and the exact size; the
+/// md5 itself remains the on-disk name for compatibility with existing caches.
+static std::string GetCacheFileName(const std::string& name, bool is_kernel_str)
+{
+    if(!is_kernel_str)
+        return name + ".o";
+
+    static std::mutex mutex;
+    static std::map<std::pair<std::uint64_t, std::size_t>, std::string> memo;
+
+    const auto key = std::make_pair(miopen::xxhash64(name), name.size());
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto it = memo.find(key);
+        if(it != memo.end())
+            return it->second;
+    }
+    auto filename = miopen::md5(name) + ".o";
+    std::lock_guard<std::mutex> lock(mutex);
+    return memo.emplace(key, std::move(filename)).first->second;
+}
+
 boost::filesystem::path GetCacheFile(const std::string& device,
                                      const std::string& name,
                                      const std::string& args,
                                      bool is_kernel_str)
 {
-    std::string filename = (is_kernel_str ? miopen::md5(name) : name) + ".o";
-    return GetCachePath(false) / miopen::md5(device + ":" + args) / filename;
+    const auto dir = miopen::Md5Hasher{}.Update(device).Update(":", 1).Update(args).Finalize();
+    return GetCachePath(false) / dir / GetCacheFileName(name, is_kernel_str);
 }
 
 #if MIOPEN_ENABLE_SQLITE_KERN_CACHE
@@ -161,7 +187,7 @@ std::string LoadBinary(const TargetProperties& target,
 
     auto db = GetDb(target, num_cu);
 
-    const std::string filename = (is_kernel_str ? miopen::md5(name) : name) + ".o";
+    const std::string filename = GetCacheFileName(name, is_kernel_str);
     KernelConfig cfg{filename, args, ""};
 
     const auto verbose_name = GetFilenameForInfo2Logging(is_kernel_str, filename, name);
@@ -191,7 +217,7 @@ void SaveBinary(const std::string& hsaco,
 
     auto db = GetDb(target, num_cu);
 
-    std::string filename = (is_kernel_str ? miopen::md5(name) : name) + ".o";
+    std::string filename = GetCacheFileName(name, is_kernel_str);
     KernelConfig cfg{filename, args, hsaco};
 
     const auto verbose_name = GetFilenameForInfo2Logging(is_kernel_str, filename, name);
@@ -40,6 +40,7 @@
 
 #include <amd_comgr.h>
 #include <hip/hip_runtime_api.h>
+#include <boost/utility/string_view.hpp>
 
 #include <algorithm>
 #include <exception>
@@ -518,7 +519,7 @@ class Data : ComgrOwner
     {
         ECI_THROW(amd_comgr_set_data_name(handle, s.c_str()), s);
     }
-    void SetBytes(const std::string& bytes) const
+    void SetBytes(const boost::string_view& bytes) const
     {
         ECI_THROW(amd_comgr_set_data(handle, bytes.size(), bytes.data()), bytes.size());
     }
@@ -565,7 +566,7 @@ class Dataset : ComgrOwner
     auto GetHandle() const { return handle; }
     void AddData(const Data& d) const { EC_THROW(amd_comgr_data_set_add(handle, d.GetHandle())); }
     void AddData(const std::string& name,
-                 const std::string& content,
+                 const boost::string_view& content,
                  const amd_comgr_data_kind_t type) const
     {
         const Data d(type);
@@ -579,7 +580,7 @@ class Dataset : ComgrOwner
            (type == AMD_COMGR_DATA_KIND_SOURCE || type == AMD_COMGR_DATA_KIND_INCLUDE))
         {
             const auto text_length = (content.size() > show_first) ? show_first : content.size();
-            const std::string text(content, 0, text_length);
+            const auto text        = content.substr(0, text_length).to_string();
             MIOPEN_LOG_I(text);
         }
     }
@@ -730,9 +731,10 @@ void BuildHip(const std::string& name,
         // of the addkernels tool. We don't do that for HIP sources, and, therefore
         // have to export include files prior compilation.
         // Note that we do not need any "subdirs" in the include "pathnames" so far.
-        const auto incNames = miopen::GetHipKernelIncList();
+        // The includes are handed to comgr straight from the embedded sources, without copies.
+        static const auto incNames = miopen::GetHipKernelIncList();
         for(const auto& inc : incNames)
-            inputs.AddData(inc, miopen::GetKernelInc(inc), AMD_COMGR_DATA_KIND_INCLUDE);
+            inputs.AddData(inc, miopen::GetKernelIncView(inc), AMD_COMGR_DATA_KIND_INCLUDE);
 
 #if COMGR_SUPPORTS_PCH
         if(compiler::lc::hip::IsPchEnabled())
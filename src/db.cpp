@@ -43,6 +43,7 @@
 #include <fstream>
 #include <ios>
 #include <mutex>
+#include <set>
 #include <shared_mutex>
 #include <string>
 #include <vector>
@@ -67,7 +68,8 @@ PlainTextDb::PlainTextDb(const std::string& filename_,
 PlainTextDb::PlainTextDb(const std::string& filename_, bool is_system)
     : filename(filename_),
       lock_file(LockFile::Get(LockFilePath(filename_).c_str())),
-      warn_if_unreadable(is_system)
+      warn_if_unreadable(is_system),
+      write_behind(!is_system && DbWriteQueue::IsEnabled())
 {
     if(!is_system)
     {
@@ -98,6 +100,25 @@ using shared_lock    = std::shared_lock<LockFile>;
 
 boost::optional<DbRecord> PlainTextDb::FindRecord(const std::string& key)
 {
+    if(write_behind)
+    {
+        // Pending modifications have to be taken before reading the file, otherwise they may
+        // be flushed and dropped from the queue in between.
+        const auto ops = DbWriteQueue::Instance().Pending(filename, key);
+        if(!ops.empty())
+        {
+            auto record = boost::optional<DbRecord>{};
+            if(!DbWriteOpsReplaceRecord(ops))
+            {
+                const auto lock = shared_lock(lock_file, GetLockTimeout());
+                MIOPEN_VALIDATE_LOCK(lock);
+                record = FindRecordUnsafe(key, nullptr);
+            }
+            ApplyDbWriteOps(ops, record);
+            return record;
+        }
+    }
+
     const auto lock = shared_lock(lock_file, GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
     return FindRecordUnsafe(key, nullptr);
@@ -105,6 +126,12 @@ boost::optional<DbRecord> PlainTextDb::FindRecord(const std::string& key)
 
 bool PlainTextDb::StoreRecord(const DbRecord& record)
 {
+    if(write_behind)
+    {
+        DbWriteQueue::Instance().Push(filename, {DbWriteOp::Kind::Store, record, {}});
+        return true;
+    }
+
     const auto lock = exclusive_lock(lock_file, GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
     return StoreRecordUnsafe(record);
@@ -112,6 +139,15 @@ bool PlainTextDb::StoreRecord(const DbRecord& record)
 
 bool PlainTextDb::UpdateRecord(DbRecord& record)
 {
+    if(write_behind)
+    {
+        const auto old_record = FindRecord(record.key);
+        DbWriteQueue::Instance().Push(filename, {DbWriteOp::Kind::Update, record, {}});
+        if(old_record)
+            record.Merge(*old_record);
+        return true;
+    }
+
     const auto lock = exclusive_lock(lock_file, GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
     return UpdateRecordUnsafe(record);
@@ -119,6 +155,12 @@ bool PlainTextDb::UpdateRecord(DbRecord& record)
 
 bool PlainTextDb::RemoveRecord(const std::string& key)
 {
+    if(write_behind)
+    {
+        DbWriteQueue::Instance().Push(filename, {DbWriteOp::Kind::RemoveRecord, DbRecord{key}, {}});
+        return true;
+    }
+
     const auto lock = exclusive_lock(lock_file, GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
     return RemoveRecordUnsafe(key);
@@ -126,6 +168,15 @@ bool PlainTextDb::RemoveRecord(const std::string& key)
 
 bool PlainTextDb::Remove(const std::string& key, const std::string& id)
 {
+    if(write_behind)
+    {
+        auto record = FindRecord(key);
+        if(!record || !record->EraseValues(id))
+            return false;
+        DbWriteQueue::Instance().Push(filename, {DbWriteOp::Kind::RemoveId, DbRecord{key}, id});
+        return true;
+    }
+
     const auto lock = exclusive_lock(lock_file, GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
     auto record = FindRecordUnsafe(key, nullptr);
@@ -137,6 +188,13 @@ bool PlainTextDb::Remove(const std::string& key, const std::string& id)
     return StoreRecordUnsafe(*record);
 }
 
+bool PlainTextDb::StoreBatch(const std::map<std::string, DbWriteOps>& ops)
+{
+    const auto lock = exclusive_lock(lock_file, GetLockTimeout());
+    MIOPEN_VALIDATE_LOCK(lock);
+    return StoreBatchUnsafe(ops);
+}
+
 boost::optional<DbRecord> PlainTextDb::FindRecordUnsafe(const std::string& key,
                                                         RecordPositions* pos)
 {
@@ -336,4 +394,71 @@ bool PlainTextDb::RemoveRecordUnsafe(const std::string& key)
     return FlushUnsafe(empty_record, &pos);
 }
 
+bool PlainTextDb::StoreBatchUnsafe(const std::map<std::string, DbWriteOps>& ops)
+{
+    MIOPEN_LOG_I2("Storing " << ops.size() << " record(s) to " << filename);
+
+    const auto temp_name = filename + ".temp";
+    {
+        std::ofstream to(temp_name);
+
+        if(!to)
+        {
+            MIOPEN_LOG_E("Temp file is unwritable: " << temp_name);
+            return false;
+        }
+
+        std::set<std::string> done;
+        std::ifstream from(filename);
+        std::string line;
+
+        // Records are located the same way as in FindRecordUnsafe(): the first well-formed
+        // line with the key is the record, everything else is copied as is.
+        while(from && std::getline(from, line))
+        {
+            const auto key_size = line.find('=');
+            const auto key =
+                key_size == std::string::npos ? std::string{} : line.substr(0, key_size);
+            const auto record_ops = ops.find(key);
+
+            if(key.empty() || key_size + 1 == line.size() || record_ops == ops.end() ||
+               done.count(key) != 0)
+            {
+                to << line << '\n';
+                continue;
+            }
+
+            auto record = boost::make_optional(DbRecord{key});
+            if(!record->ParseContents(line.substr(key_size + 1)))
+                MIOPEN_LOG_E("Error parsing payload under the key: " << key << " form file "
+                                                                     << filename);
+            ApplyDbWriteOps(record_ops->second, record);
+            if(record)
+                record->WriteContents(to);
+            done.insert(key);
+        }
+
+        for(const auto& record_ops : ops)
+        {
+            if(done.count(record_ops.first) != 0)
+                continue;
+            auto record = boost::optional<DbRecord>{};
+            ApplyDbWriteOps(record_ops.second, record);
+            if(record)
+                record->WriteContents(to);
+        }
+
+        if(!to)
+        {
+            MIOPEN_LOG_E("Temp file is unwritable: " << temp_name);
+            return false;
+        }
+    }
+
+    std::remove(filename.c_str());
+    std::rename(temp_name.c_str(), filename.c_str());
+    boost::filesystem::permissions(filename, boost::filesystem::all_all);
+    return true;
+}
+
 } // namespace miopen
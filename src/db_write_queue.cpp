@@ -0,0 +1,206 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/db_write_queue.hpp>
+#include <miopen/db.hpp>
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+
+#include <chrono>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_USER_DB_WRITE_BEHIND)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_USER_DB_WRITE_BEHIND_INTERVAL_MS)
+
+namespace miopen {
+
+bool testing_db_write_behind = false; // NOLINT (cppcoreguidelines-avoid-non-const-global-variables)
+
+void ApplyDbWriteOps(const DbWriteOps& ops, boost::optional<DbRecord>& record)
+{
+    for(const auto& op : ops)
+    {
+        switch(op.kind)
+        {
+        case DbWriteOp::Kind::Store: record = op.record; break;
+        case DbWriteOp::Kind::Update:
+            if(record)
+            {
+                auto merged = op.record;
+                merged.Merge(*record);
+                record = std::move(merged);
+            }
+            else
+            {
+                record = op.record;
+            }
+            break;
+        case DbWriteOp::Kind::RemoveRecord: record = boost::none; break;
+        case DbWriteOp::Kind::RemoveId:
+            if(record)
+                record->EraseValues(op.id);
+            break;
+        }
+
+        if(record && record->GetSize() == 0)
+            record = boost::none;
+    }
+}
+
+bool DbWriteOpsReplaceRecord(const DbWriteOps& ops)
+{
+    return !ops.empty() && (ops.front().kind == DbWriteOp::Kind::Store ||
+                            ops.front().kind == DbWriteOp::Kind::RemoveRecord);
+}
+
+bool DbWriteQueue::IsEnabled()
+{
+    return testing_db_write_behind || miopen::IsEnabled(MIOPEN_DEBUG_USER_DB_WRITE_BEHIND{});
+}
+
+DbWriteQueue& DbWriteQueue::Instance()
+{
+    // The destructor flushes the queue at process exit.
+    static DbWriteQueue queue;
+    return queue;
+}
+
+void DbWriteQueue::FlushAll()
+{
+    if(IsEnabled())
+        Instance().Flush();
+}
+
+DbWriteQueue::DbWriteQueue() : worker([this]() { Worker(); }) {}
+
+DbWriteQueue::~DbWriteQueue()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    wakeup.notify_one();
+    worker.join();
+    Flush();
+}
+
+void DbWriteQueue::Push(const std::string& filename, DbWriteOp op)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& ops = pending[filename][op.record.GetKey()];
+
+    switch(op.kind)
+    {
+    case DbWriteOp::Kind::Store:
+    case DbWriteOp::Kind::RemoveRecord: ops.clear(); break;
+    case DbWriteOp::Kind::Update:
+        if(!ops.empty() && (ops.back().kind == DbWriteOp::Kind::Update ||
+                            ops.back().kind == DbWriteOp::Kind::Store))
+        {
+            op.record.Merge(ops.back().record);
+            ops.back().record = std::move(op.record);
+            return;
+        }
+        break;
+    case DbWriteOp::Kind::RemoveId: break;
+    }
+
+    ops.push_back(std::move(op));
+}
+
+DbWriteOps DbWriteQueue::Pending(const std::string& filename, const std::string& key) const
+{
+    auto ret = DbWriteOps{};
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // In-flight modifications may or may not be in the file already. Applying them twice is
+    // harmless as every op is idempotent.
+    for(const auto* batch : {&in_flight, &pending})
+    {
+        const auto file = batch->find(filename);
+        if(file == batch->end())
+            continue;
+        const auto record = file->second.find(key);
+        if(record == file->second.end())
+            continue;
+        ret.insert(ret.end(), record->second.begin(), record->second.end());
+    }
+
+    return ret;
+}
+
+void DbWriteQueue::Flush()
+{
+    std::lock_guard<std::mutex> lock(flush_mutex);
+    FlushUnsafe();
+}
+
+void DbWriteQueue::FlushUnsafe()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(pending.empty())
+            return;
+        in_flight.swap(pending);
+    }
+
+    for(const auto& file : in_flight)
+    {
+        MIOPEN_LOG_I2("Flushing " << file.second.size() << " record(s) to " << file.first);
+        try
+        {
+            if(PlainTextDb(file.first).StoreBatch(file.second))
+                continue;
+        }
+        catch(const Exception& ex)
+        {
+            // This runs on the worker thread and from destructors, so nothing may escape.
+            MIOPEN_LOG_E(ex.what());
+        }
+        MIOPEN_LOG_E("Failed to flush records to <" << file.first << ">");
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    in_flight.clear();
+}
+
+void DbWriteQueue::Worker()
+{
+    const auto interval =
+        std::chrono::milliseconds{Value(MIOPEN_DEBUG_USER_DB_WRITE_BEHIND_INTERVAL_MS{}, 200)};
+
+    while(true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeup.wait_for(lock, interval, [this]() { return stop; });
+            if(stop)
+                return;
+        }
+        Flush();
+    }
+}
+
+} // namespace miopen
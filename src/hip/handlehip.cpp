@@ -28,6 +28,7 @@
 #include <miopen/handle.hpp>
 
 #include <miopen/binary_cache.hpp>
+#include <miopen/db_write_queue.hpp>
 #include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/gemm_geometry.hpp>
@@ -247,7 +248,7 @@ Handle::Handle() : impl(new HandleImpl())
     MIOPEN_LOG_NQI(*this);
 }
 
-Handle::~Handle() {}
+Handle::~Handle() { DbWriteQueue::FlushAll(); }
 
 void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
 {
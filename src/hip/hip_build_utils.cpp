@@ -34,6 +34,7 @@
 #include <miopen/solver/implicitgemm_util.hpp>
 #include <miopen/target_properties.hpp>
 #include <boost/optional.hpp>
+#include <mutex>
 #include <sstream>
 #include <string>
 
@@ -84,6 +85,19 @@ inline const std::string& GetCoV3Option(const bool enable)
     else
         return no_option;
 }
+
+/// All HIP kernels share the same set of headers (composable_kernel etc). These are exported
+/// once per process instead of being written into the temporary directory of each build.
+const boost::filesystem::path& GetHipKernelIncDir()
+{
+    static const TmpDir dir{"hip-includes"};
+    static std::once_flag written;
+    std::call_once(written, []() {
+        for(const auto& inc_file : GetHipKernelIncList())
+            WriteFile(GetKernelInc(inc_file), dir.path / inc_file);
+    });
+    return dir.path;
+}
 } // namespace
 
 static boost::filesystem::path HipBuildImpl(boost::optional<TmpDir>& tmp_dir,
@@ -95,19 +109,9 @@ static boost::filesystem::path HipBuildImpl(boost::optional<TmpDir>& tmp_dir,
                                             const bool sources_already_reside_on_filesystem)
 {
 #ifdef __linux__
-    // Write out the include files
     // Let's assume includes are overkill for feature tests & optimize'em out.
     if(!testing_mode)
-    {
-        auto inc_list = GetHipKernelIncList();
-        auto inc_path = tmp_dir->path;
-        boost::filesystem::create_directories(inc_path);
-        for(auto inc_file : inc_list)
-        {
-            auto inc_src = GetKernelInc(inc_file);
-            WriteFile(inc_src, inc_path / inc_file);
-        }
-    }
+        params += " -I" + GetHipKernelIncDir().string();
 
     // Sources produced by MLIR-cpp already reside in tmp dir.
     if(!sources_already_reside_on_filesystem)
@@ -27,6 +27,7 @@
 #define GUARD_MIOPEN_DB_HPP_
 
 #include <miopen/db_record.hpp>
+#include <miopen/db_write_queue.hpp>
 #include <miopen/rank.hpp>
 
 #include <boost/core/explicit_operator_bool.hpp>
@@ -34,6 +35,7 @@
 #include <boost/optional/optional.hpp>
 
 #include <chrono>
+#include <map>
 #include <string>
 
 namespace boost {
@@ -100,6 +102,11 @@ class PlainTextDb
 
     bool Remove(const std::string& key, const std::string& id);
 
+    /// Applies modifications of several records with a single rewrite of the file.
+    ///
+    /// Returns true if the file was written successfully, false otherwise.
+    bool StoreBatch(const std::map<std::string, DbWriteOps>& ops);
+
     template <class T>
     inline bool RemoveRecord(const T& problem_config)
     {
@@ -145,12 +152,14 @@ class PlainTextDb
     std::string filename;
     LockFile& lock_file;
     const bool warn_if_unreadable;
+    const bool write_behind;
 
     boost::optional<DbRecord> FindRecordUnsafe(const std::string& key, RecordPositions* pos);
     bool FlushUnsafe(const DbRecord& record, const RecordPositions* pos);
     bool StoreRecordUnsafe(const DbRecord& record);
     bool UpdateRecordUnsafe(DbRecord& record);
     bool RemoveRecordUnsafe(const std::string& key);
+    bool StoreBatchUnsafe(const std::map<std::string, DbWriteOps>& ops);
 
     template <class T>
     inline boost::optional<DbRecord> FindRecordUnsafe(const T& problem_config)
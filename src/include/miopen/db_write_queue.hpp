@@ -0,0 +1,113 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_DB_WRITE_QUEUE_HPP_
+#define GUARD_MIOPEN_DB_WRITE_QUEUE_HPP_
+
+#include <miopen/db_record.hpp>
+
+#include <boost/optional/optional.hpp>
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+
+/// A modification of a single db record which has not reached the file yet.
+struct DbWriteOp
+{
+    enum class Kind
+    {
+        Store,        // Replace the record.
+        Update,       // Merge into the record, replacing values with the same id.
+        RemoveRecord, // Remove the whole record.
+        RemoveId,     // Remove a single id from the record.
+    };
+
+    Kind kind;
+    DbRecord record;
+    std::string id;
+};
+
+using DbWriteOps = std::vector<DbWriteOp>;
+
+/// Applies ops to the record in order. An empty record is returned as none.
+void ApplyDbWriteOps(const DbWriteOps& ops, boost::optional<DbRecord>& record);
+
+/// True if the result of ops does not depend on the record stored in the file.
+bool DbWriteOpsReplaceRecord(const DbWriteOps& ops);
+
+// For unit tests.
+extern bool testing_db_write_behind; // NOLINT (cppcoreguidelines-avoid-non-const-global-variables)
+
+/// Write-behind queue for user databases. Modifications are coalesced per key and written
+/// to the files by a background thread, one rewrite per file per batch.
+///
+/// The queue is flushed when a handle is destroyed and at process exit. Reads through
+/// PlainTextDb consult the pending modifications, so the process always sees its own writes.
+class DbWriteQueue
+{
+    public:
+    static bool IsEnabled();
+    static DbWriteQueue& Instance();
+
+    /// Writes everything queued so far if the queue is enabled; otherwise does nothing.
+    static void FlushAll();
+
+    DbWriteQueue(const DbWriteQueue&) = delete;
+    DbWriteQueue& operator=(const DbWriteQueue&) = delete;
+    ~DbWriteQueue();
+
+    void Push(const std::string& filename, DbWriteOp op);
+
+    /// Returns the modifications of the record which are not in the file yet, oldest first.
+    DbWriteOps Pending(const std::string& filename, const std::string& key) const;
+
+    /// Blocks until everything queued so far is written.
+    void Flush();
+
+    private:
+    using FileOps = std::map<std::string, DbWriteOps>;
+
+    DbWriteQueue();
+    void Worker();
+    void FlushUnsafe();
+
+    mutable std::mutex mutex;
+    std::mutex flush_mutex;
+    std::condition_variable wakeup;
+    std::map<std::string, FileOps> pending;
+    std::map<std::string, FileOps> in_flight;
+    bool stop = false;
+    std::thread worker;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_DB_WRITE_QUEUE_HPP_
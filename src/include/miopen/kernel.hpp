@@ -26,14 +26,23 @@
 #ifndef GUARD_MIOPEN_KERNEL_HPP
 #define GUARD_MIOPEN_KERNEL_HPP
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
+#include <boost/utility/string_view.hpp>
+
 #include <miopen/config.h>
 
 namespace miopen {
 std::string GetKernelSrc(std::string name);
+/// Zero-copy view of the embedded kernel source. Throws if the kernel is unknown.
+boost::string_view GetKernelSrcView(const std::string& name);
+/// Content hash of the embedded (inlined) kernel source, computed at build time.
+std::uint64_t GetKernelSrcHash(const std::string& name);
 std::string GetKernelInc(std::string key);
+boost::string_view GetKernelIncView(const std::string& key);
+std::uint64_t GetKernelIncHash(const std::string& key);
 std::vector<std::string> GetKernelIncList();
 std::vector<std::string> GetHipKernelIncList();
 } // namespace miopen
@@ -0,0 +1,64 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_KERNEL_TABLE_HPP
+#define GUARD_MIOPEN_KERNEL_TABLE_HPP
+
+#include <boost/utility/string_view.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace miopen {
+
+/// One source file embedded into the library by addkernels.
+/// The text is not copied: data points to the read-only array generated at build time.
+struct KernelTableEntry
+{
+    const char* name;
+    const char* data;
+    std::size_t size;
+    std::uint64_t hash; // FNV-1a of the content, computed at build time
+
+    boost::string_view Source() const { return {data, size}; }
+};
+
+/// The generated tables are sorted by name at configure time, thus binary search is enough.
+inline const KernelTableEntry* FindKernelTableEntry(const KernelTableEntry* begin,
+                                                    const KernelTableEntry* end,
+                                                    const boost::string_view& name)
+{
+    const auto it = std::lower_bound(begin, end, name, [](const auto& entry, const auto& key) {
+        return boost::string_view{entry.name} < key;
+    });
+    if(it == end || boost::string_view{it->name} != name)
+        return nullptr;
+    return it;
+}
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_KERNEL_TABLE_HPP
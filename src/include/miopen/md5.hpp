@@ -1,11 +1,37 @@
 #ifndef GUARD_MLOPEN_MD5_HPP
 #define GUARD_MLOPEN_MD5_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace miopen {
 
-std::string md5(std::string s);
+/// Streaming md5. Use it for anything that ends up on disk (cache file names,
+/// integrity checks); in-process keys should prefer the cheaper xxhash64.
+class Md5Hasher
+{
+    public:
+    struct Context
+    {
+        std::uint32_t lo, hi;
+        std::uint32_t a, b, c, d;
+        unsigned char buffer[64];
+        std::uint32_t block[16];
+    };
+
+    Md5Hasher();
+
+    Md5Hasher& Update(const void* data, std::size_t size);
+    Md5Hasher& Update(const std::string& s) { return Update(s.data(), s.size()); }
+    /// Returns the lowercase hex digest and resets the hasher for reuse.
+    std::string Finalize();
+
+    private:
+    Context ctx{};
+};
+
+std::string md5(const std::string& s);
 
 } // namespace miopen
 
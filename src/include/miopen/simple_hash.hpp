@@ -27,6 +27,8 @@
 #ifndef GUARD_MLOPEN_SIMPLE_HASH_HPP
 #define GUARD_MLOPEN_SIMPLE_HASH_HPP
 
+#include <miopen/xxhash.hpp>
+
 #include <string>
 
 namespace miopen {
@@ -34,8 +36,8 @@ struct SimpleHash
 {
     size_t operator()(const std::pair<std::string, std::string>& p) const
     {
-        using std::hash;
-        return (hash<std::string>()(p.first) ^ hash<std::string>()(p.second));
+        // Chaining the seed keeps (a, b) and (b, a) apart, unlike xor-ing two hashes.
+        return static_cast<size_t>(xxhash64(p.second, xxhash64(p.first)));
     }
 };
 
@@ -0,0 +1,62 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_XXHASH_HPP
+#define GUARD_MIOPEN_XXHASH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace miopen {
+
+/// Streaming xxHash64. A fast non-cryptographic hash for in-process keys only:
+/// anything that is persisted (cache file names, database records) must keep using md5.
+class XxHash64
+{
+    public:
+    explicit XxHash64(std::uint64_t seed = 0);
+
+    XxHash64& Update(const void* data, std::size_t size);
+    XxHash64& Update(const std::string& s) { return Update(s.data(), s.size()); }
+    std::uint64_t Finalize() const;
+
+    private:
+    std::uint64_t acc[4];
+    std::uint64_t seed;
+    std::uint64_t total_size = 0;
+    unsigned char buffer[32];
+    std::size_t buffered = 0;
+};
+
+std::uint64_t xxhash64(const void* data, std::size_t size, std::uint64_t seed = 0);
+inline std::uint64_t xxhash64(const std::string& s, std::uint64_t seed = 0)
+{
+    return xxhash64(s.data(), s.size(), seed);
+}
+
+} // namespace miopen
+
+#endif
@@ -27,6 +27,7 @@
 #include <miopen/handle.hpp>
 
 #include <miopen/binary_cache.hpp>
+#include <miopen/db_write_queue.hpp>
 #include <miopen/config.h>
 #include <miopen/env.hpp>
 #include <miopen/errors.hpp>
@@ -260,7 +261,7 @@ Handle::Handle() : impl(new HandleImpl())
 }
 
 Handle::Handle(Handle&&) noexcept = default;
-Handle::~Handle()                 = default;
+Handle::~Handle() { DbWriteQueue::FlushAll(); }
 
 void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
 {
@@ -34,6 +34,13 @@
 **    freeonclose=  If true, then sqlite3_free() is called on the ptr=
 **                  value when the connection closes.
 **
+**    readonly=     If true, the buffer is never written.  Writes and
+**                  truncation fail with SQLITE_READONLY, the file is
+**                  reported as immutable (no locking or change detection)
+**                  and, with PRAGMA mmap_size set, pages are handed out
+**                  directly from the buffer via xFetch without a copy.
+**                  The buffer should be aligned to the database page size.
+**
 ** The ptr= and sz= query parameters are required.  If maxsz= is omitted,
 ** then it defaults to the sz= value.  Parameter values can be in either
 ** decimal or hexadecimal.  The filename in the URI is ignored.
@@ -64,6 +71,7 @@ struct MemFile
     sqlite3_int64 szMax;  /* Space allocated to aData */
     unsigned char* aData; /* content of the file */
     int bFreeOnClose;     /* Invoke sqlite3_free() on aData at close */
+    int bReadOnly;        /* aData is immutable, reject all writes */
 };
 
 /*
@@ -179,6 +187,8 @@ static int memRead(sqlite3_file* pFile, void* zBuf, int iAmt, sqlite_int64 iOfst
 static int memWrite(sqlite3_file* pFile, const void* z, int iAmt, sqlite_int64 iOfst)
 {
     MemFile* p = (MemFile*)pFile;
+    if(p->bReadOnly)
+        return SQLITE_READONLY;
     if(iOfst + iAmt > p->sz)
     {
         if(iOfst + iAmt > p->szMax)
@@ -197,6 +207,8 @@ static int memWrite(sqlite3_file* pFile, const void* z, int iAmt, sqlite_int64 i
 static int memTruncate(sqlite3_file* pFile, sqlite_int64 size)
 {
     MemFile* p = (MemFile*)pFile;
+    if(p->bReadOnly)
+        return SQLITE_READONLY;
     if(size > p->sz)
     {
         if(size > p->szMax)
@@ -266,6 +278,9 @@ static int memSectorSize(sqlite3_file* pFile) { return 1024; }
 */
 static int memDeviceCharacteristics(sqlite3_file* pFile)
 {
+    MemFile* p = (MemFile*)pFile;
+    if(p->bReadOnly)
+        return SQLITE_IOCAP_IMMUTABLE;
     return SQLITE_IOCAP_ATOMIC | SQLITE_IOCAP_POWERSAFE_OVERWRITE | SQLITE_IOCAP_SAFE_APPEND |
            SQLITE_IOCAP_SEQUENTIAL;
 }
@@ -288,11 +303,19 @@ static void memShmBarrier(sqlite3_file* pFile) { return; }
 /* Unmap a shared memory segment */
 static int memShmUnmap(sqlite3_file* pFile, int deleteFlag) { return SQLITE_OK; }
 
-/* Fetch a page of a memory-mapped file */
+/*
+** Fetch a page of a memory-mapped file.  Requests past the end of the
+** buffer return a NULL pointer so that SQLite falls back to xRead.
+*/
 static int memFetch(sqlite3_file* pFile, sqlite3_int64 iOfst, int iAmt, void** pp)
 {
     MemFile* p = (MemFile*)pFile;
-    *pp        = (void*)(p->aData + iOfst);
+    if(iOfst + iAmt > p->sz)
+    {
+        *pp = 0;
+        return SQLITE_OK;
+    }
+    *pp = (void*)(p->aData + iOfst);
     return SQLITE_OK;
 }
 
@@ -319,6 +342,13 @@ memOpen(sqlite3_vfs* pVfs, const char* zName, sqlite3_file* pFile, int flags, in
     if(p->szMax < p->sz)
         return SQLITE_CANTOPEN;
     p->bFreeOnClose = sqlite3_uri_boolean(zName, "freeonclose", 0);
+    p->bReadOnly    = sqlite3_uri_boolean(zName, "readonly", 0);
+    if(p->bReadOnly)
+    {
+        p->szMax = p->sz;
+        if(pOutFlags)
+            *pOutFlags = (flags & ~SQLITE_OPEN_READWRITE) | SQLITE_OPEN_READONLY;
+    }
     pFile->pMethods = &mem_io_methods;
     return SQLITE_OK;
 }
@@ -538,7 +568,7 @@ __declspec(dllexport)
     SQLITE_EXTENSION_INIT2(pApi);
     mem_vfs.pAppData = sqlite3_vfs_find(0);
     mem_vfs.szOsFile = sizeof(MemFile);
-    rc               = sqlite3_vfs_register(&mem_vfs, 1);
+    rc               = sqlite3_vfs_register(&mem_vfs, 0); /* not default, opened by name */
 #ifdef MEMVFS_TEST
     if(rc == SQLITE_OK)
     {
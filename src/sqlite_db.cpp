@@ -26,6 +26,7 @@
 #include <miopen/sqlite_db.hpp>
 #include <miopen/db_record.hpp>
 #include <miopen/errors.hpp>
+#include <miopen/env.hpp>
 #include <miopen/lock_file.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/md5.hpp>
@@ -57,6 +58,10 @@ int miopen_sqlite3_memvfs_init(sqlite3* db, char** pzErrMsg, const sqlite3_api_r
 }
 namespace miopen {
 
+#if MIOPEN_EMBED_DB
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_EMBED_DB_USER_OVERLAY)
+#endif
+
 class SQLite::impl
 {
     struct SQLiteCloser
@@ -74,22 +79,55 @@ class SQLite::impl
     };
     using sqlite3_ptr = std::unique_ptr<sqlite3, SQLiteCloser>;
 #if MIOPEN_EMBED_DB
+    static void RegisterMemVfs()
+    {
+        // The extension returns SQLITE_OK_LOAD_PERMANENTLY, thus the VFS stays registered after
+        // the first connection is closed and the auto extension is no longer required.
+        static std::once_flag once;
+        std::call_once(once, []() {
+            const auto init = reinterpret_cast<void (*)(void)>(miopen_sqlite3_memvfs_init);
+            sqlite3_auto_extension(init);
+            sqlite3* ptr_tmp = nullptr;
+            // Open an in-memory database to use as a handle for loading the memvfs extension
+            if(sqlite3_open(":memory:", &ptr_tmp) != SQLITE_OK)
+            {
+                const auto msg = std::string(sqlite3_errmsg(ptr_tmp));
+                sqlite3_close(ptr_tmp);
+                sqlite3_cancel_auto_extension(init);
+                MIOPEN_THROW(miopenStatusInternalError, "open :memory: " + msg);
+            }
+            sqlite3_close(ptr_tmp);
+            sqlite3_cancel_auto_extension(init);
+        });
+    }
+
+    static int ExecPragma(sqlite3* ptr, const std::string& pragma)
+    {
+        sqlite3_stmt* stmt;
+        if(sqlite3_prepare_v2(ptr, pragma.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
+        {
+            const auto msg = std::string(sqlite3_errmsg(ptr));
+            sqlite3_close(ptr);
+            MIOPEN_THROW(miopenStatusInternalError, "prepare: " + msg);
+        }
+        int rc = 0;
+        for(rc = sqlite3_step(stmt); rc == SQLITE_ROW; rc = sqlite3_step(stmt))
+        {
+        }
+        if(rc == SQLITE_DONE)
+            rc = 0;
+
+        sqlite3_finalize(stmt);
+        return rc;
+    }
+
     int CreateInMemDb(const boost::filesystem::path& filepath, bool is_system)
     {
         sqlite3* ptr_tmp = nullptr;
         int rc           = 0;
-        sqlite3_auto_extension(reinterpret_cast<void (*)(void)>(miopen_sqlite3_memvfs_init));
-        // Open an in-memory database to use as a handle for loading the memvfs extension
-        if(sqlite3_open(":memory:", &ptr_tmp) != SQLITE_OK)
-        {
-            MIOPEN_THROW(miopenStatusInternalError,
-                         "open :memory: " + std::string(sqlite3_errmsg(ptr_tmp)));
-        }
-        sqlite3_enable_load_extension(ptr_tmp, 1);
-        sqlite3_close(ptr_tmp);
         if(is_system)
         {
-
+            RegisterMemVfs();
             const auto& it_p = miopen_data().find(filepath.filename().string() + ".o");
             if(it_p == miopen_data().end())
             {
@@ -98,45 +136,42 @@ class SQLite::impl
             }
             const auto& p    = it_p->second;
             ptrdiff_t ptr_sz = p.second - p.first;
-            char* memuri     = sqlite3_mprintf(
-                "file:ignoredFilename?ptr=0x%p&sz=%lld", p.first, static_cast<long long>(ptr_sz));
-            if(sqlite3_open_v2(
-                   memuri, &ptr_tmp, SQLITE_OPEN_READWRITE | SQLITE_OPEN_URI, nullptr) != SQLITE_OK)
+            // The embedded blob lives in .rodata, the VFS serves the pages straight from it.
+            char* memuri = sqlite3_mprintf("file:ignoredFilename?ptr=0x%p&sz=%lld&readonly=1",
+                                           p.first,
+                                           static_cast<long long>(ptr_sz));
+            rc           = sqlite3_open_v2(
+                memuri, &ptr_tmp, SQLITE_OPEN_READONLY | SQLITE_OPEN_URI, "memvfs");
+            sqlite3_free(memuri);
+            if(rc != SQLITE_OK)
             {
-                MIOPEN_THROW(miopenStatusInternalError,
-                             "open memvfs: " + std::string(sqlite3_errmsg(ptr_tmp)));
+                const auto msg = std::string(sqlite3_errmsg(ptr_tmp));
+                sqlite3_close(ptr_tmp);
+                MIOPEN_THROW(miopenStatusInternalError, "open memvfs: " + msg);
             }
-            sqlite3_free(memuri);
+            // Enable xFetch for the whole blob so that no page is copied into the page cache.
+            rc = ExecPragma(ptr_tmp, "PRAGMA mmap_size=" + std::to_string(ptr_sz) + ";");
         }
-        else
+        else if(miopen::IsEnabled(MIOPEN_DEBUG_EMBED_DB_USER_OVERLAY{}))
         {
-            char* memuri = sqlite3_mprintf(":memory:");
-            if(sqlite3_open_v2(
-                   memuri, &ptr_tmp, SQLITE_OPEN_READWRITE | SQLITE_OPEN_URI, nullptr) != SQLITE_OK)
-            {
-                MIOPEN_THROW(miopenStatusInternalError,
-                             "open memvfs: " + std::string(sqlite3_errmsg(ptr_tmp)));
-            }
-            sqlite3_free(memuri);
+            // Write-through overlay: the user db goes to the regular file so that the tuning
+            // results survive the process.
+            MIOPEN_LOG_I2("Using user database overlay file: " << filepath.string());
+            return CreateFileDb(filepath, false);
         }
-        // set journal mode to off
+        else
         {
-            sqlite3_stmt* stmt;
-            if(sqlite3_prepare_v2(ptr_tmp, "PRAGMA journal_mode=off;", -1, &stmt, nullptr) !=
+            if(sqlite3_open_v2(":memory:", &ptr_tmp, SQLITE_OPEN_READWRITE, nullptr) !=
                SQLITE_OK)
             {
-                fprintf(stderr, "prepare: %s\n", sqlite3_errmsg(ptr_tmp));
+                const auto msg = std::string(sqlite3_errmsg(ptr_tmp));
                 sqlite3_close(ptr_tmp);
-                MIOPEN_THROW(miopenStatusInternalError);
+                MIOPEN_THROW(miopenStatusInternalError, "open :memory: " + msg);
             }
-            for(rc = sqlite3_step(stmt); rc == SQLITE_ROW; rc = sqlite3_step(stmt))
-            {
-            }
-            if(rc == SQLITE_DONE)
-                rc = 0;
-
-            sqlite3_finalize(stmt);
         }
+        // set journal mode to off
+        if(rc == 0)
+            rc = ExecPragma(ptr_tmp, "PRAGMA journal_mode=off;");
         ptrDb = sqlite3_ptr{ptr_tmp};
         return rc;
     }
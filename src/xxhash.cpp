@@ -0,0 +1,193 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/xxhash.hpp>
+
+#include <cstring>
+
+namespace miopen {
+
+namespace {
+
+constexpr std::uint64_t Prime1 = 0x9E3779B185EBCA87ull;
+constexpr std::uint64_t Prime2 = 0xC2B2AE3D27D4EB4Full;
+constexpr std::uint64_t Prime3 = 0x165667B19E3779F9ull;
+constexpr std::uint64_t Prime4 = 0x85EBCA77C2B2AE63ull;
+constexpr std::uint64_t Prime5 = 0x27D4EB2F165667C5ull;
+
+inline std::uint64_t RotL(std::uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+// The reference implementation reads the input in little-endian order.
+inline std::uint64_t Read64(const unsigned char* p)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+#else
+    std::uint64_t v = 0;
+    for(auto i = 7; i >= 0; --i)
+        v = (v << 8) | p[i];
+    return v;
+#endif
+}
+
+inline std::uint32_t Read32(const unsigned char* p)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+#else
+    std::uint32_t v = 0;
+    for(auto i = 3; i >= 0; --i)
+        v = (v << 8) | p[i];
+    return v;
+#endif
+}
+
+inline std::uint64_t Round(std::uint64_t acc, std::uint64_t input)
+{
+    acc += input * Prime2;
+    acc = RotL(acc, 31);
+    return acc * Prime1;
+}
+
+inline std::uint64_t MergeRound(std::uint64_t acc, std::uint64_t val)
+{
+    acc ^= Round(0, val);
+    return acc * Prime1 + Prime4;
+}
+
+inline const unsigned char* ConsumeStripes(std::uint64_t (&acc)[4],
+                                           const unsigned char* p,
+                                           const unsigned char* const limit)
+{
+    do
+    {
+        acc[0] = Round(acc[0], Read64(p));
+        acc[1] = Round(acc[1], Read64(p + 8));
+        acc[2] = Round(acc[2], Read64(p + 16));
+        acc[3] = Round(acc[3], Read64(p + 24));
+        p += 32;
+    } while(p <= limit);
+    return p;
+}
+
+} // namespace
+
+XxHash64::XxHash64(std::uint64_t seed_) : seed(seed_)
+{
+    acc[0] = seed + Prime1 + Prime2;
+    acc[1] = seed + Prime2;
+    acc[2] = seed;
+    acc[3] = seed - Prime1;
+}
+
+XxHash64& XxHash64::Update(const void* data, std::size_t size)
+{
+    auto p         = static_cast<const unsigned char*>(data);
+    const auto end = p + size;
+    total_size += size;
+
+    if(buffered + size < sizeof(buffer))
+    {
+        std::memcpy(buffer + buffered, p, size);
+        buffered += size;
+        return *this;
+    }
+
+    if(buffered != 0)
+    {
+        const auto fill = sizeof(buffer) - buffered;
+        std::memcpy(buffer + buffered, p, fill);
+        ConsumeStripes(acc, buffer, buffer);
+        p += fill;
+        buffered = 0;
+    }
+
+    if(end - p >= 32)
+        p = ConsumeStripes(acc, p, end - 32);
+
+    buffered = end - p;
+    std::memcpy(buffer, p, buffered);
+    return *this;
+}
+
+std::uint64_t XxHash64::Finalize() const
+{
+    std::uint64_t h;
+
+    if(total_size >= 32)
+    {
+        h = RotL(acc[0], 1) + RotL(acc[1], 7) + RotL(acc[2], 12) + RotL(acc[3], 18);
+        h = MergeRound(h, acc[0]);
+        h = MergeRound(h, acc[1]);
+        h = MergeRound(h, acc[2]);
+        h = MergeRound(h, acc[3]);
+    }
+    else
+    {
+        h = seed + Prime5;
+    }
+
+    h += total_size;
+
+    auto p         = buffer;
+    const auto end = buffer + buffered;
+
+    for(; p + 8 <= end; p += 8)
+    {
+        h ^= Round(0, Read64(p));
+        h = RotL(h, 27) * Prime1 + Prime4;
+    }
+
+    if(p + 4 <= end)
+    {
+        h ^= static_cast<std::uint64_t>(Read32(p)) * Prime1;
+        h = RotL(h, 23) * Prime2 + Prime3;
+        p += 4;
+    }
+
+    for(; p < end; ++p)
+    {
+        h ^= *p * Prime5;
+        h = RotL(h, 11) * Prime1;
+    }
+
+    h ^= h >> 33;
+    h *= Prime2;
+    h ^= h >> 29;
+    h *= Prime3;
+    h ^= h >> 32;
+    return h;
+}
+
+std::uint64_t xxhash64(const void* data, std::size_t size, std::uint64_t seed)
+{
+    return XxHash64{seed}.Update(data, size).Finalize();
+}
+
+} // namespace miopen
@@ -29,10 +29,10 @@
 #include <miopen/temp_file.hpp>
 
 #include <miopen/md5.hpp>
+#include <miopen/xxhash.hpp>
 #include "test.hpp"
 #include "random.hpp"
 
-#if MIOPEN_ENABLE_SQLITE
 std::string random_string(size_t length)
 {
     auto randchar = []() -> char {
@@ -47,6 +47,7 @@ std::string random_string(size_t length)
     return str;
 }
 
+#if MIOPEN_ENABLE_SQLITE
 void check_bz2_compress()
 {
     std::string to_compress;
@@ -146,10 +147,51 @@ void check_cache_str()
     CHECK(p.filename().string() == name + ".o");
 }
 
+void check_cache_dir()
+{
+    auto p = miopen::GetCacheFile("gfx", "base", "args", false);
+    CHECK(p.parent_path().filename().string() == miopen::md5("gfx:args"));
+}
+
+void check_md5_streaming()
+{
+    CHECK(miopen::md5("") == "d41d8cd98f00b204e9800998ecf8427e");
+    CHECK(miopen::md5("abc") == "900150983cd24fb0d6963f7d28e17f72");
+
+    const auto str = random_string(1000);
+    miopen::Md5Hasher hasher;
+    for(std::size_t i = 0; i < str.size(); i += 37)
+        hasher.Update(str.data() + i, std::min<std::size_t>(37, str.size() - i));
+    CHECK(hasher.Finalize() == miopen::md5(str));
+    // Finalize() resets the hasher.
+    CHECK(hasher.Update("abc").Finalize() == miopen::md5("abc"));
+}
+
+void check_xxhash64()
+{
+    CHECK(miopen::xxhash64("") == 0xef46db3751d8e999ull);
+    CHECK(miopen::xxhash64("a") == 0xd24ec4f1a98c6e5bull);
+    CHECK(miopen::xxhash64("abc") == 0x44bc2cf5ad770999ull);
+    CHECK(miopen::xxhash64("Nobody inspects the spammish repetition") == 0xfbcea83c8a378bf1ull);
+    CHECK(miopen::xxhash64("abc", 1) != miopen::xxhash64("abc"));
+
+    const auto str = random_string(1000);
+    for(std::size_t step : {1, 7, 31, 32, 33, 100})
+    {
+        miopen::XxHash64 hasher;
+        for(std::size_t i = 0; i < str.size(); i += step)
+            hasher.Update(str.data() + i, std::min(step, str.size() - i));
+        CHECK(hasher.Finalize() == miopen::xxhash64(str));
+    }
+}
+
 int main()
 {
     check_cache_file();
     check_cache_str();
+    check_cache_dir();
+    check_md5_streaming();
+    check_xxhash64();
 #if MIOPEN_ENABLE_SQLITE
     check_bz2_compress();
     check_bz2_decompress();
@@ -32,6 +32,7 @@
 
 #include <string>
 #include <fstream>
+#include <iterator>
 
 #include <boost/filesystem.hpp>
 
@@ -81,6 +82,12 @@ namespace tests {
 
 class InlinerTest
 {
+    static std::string ReadAll(const bf::path& path)
+    {
+        std::ifstream file(path.c_str());
+        return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+
     public:
     void Run(const bf::path& exe_path) const
     {
@@ -106,6 +113,24 @@ class InlinerTest
         EXPECT_EQUAL(0, Child(addkernels, addkernels + " -source " + valid_src.string()));
         EXPECT_EQUAL(0, Child(addkernels, addkernels + " -source " + asm_src.string()));
         EXPECT_EQUAL(1, Child(addkernels, addkernels + " -source " + invalid_src.string()));
+
+        // The second run is served from the cache and must produce the same output.
+        const auto cache_dir = test_srcs.path / "cache";
+        const auto depfile   = test_srcs.path / "valid.d";
+        bf::create_directories(cache_dir);
+        const auto run_cached = [&](const bf::path& target) {
+            return Child(addkernels,
+                         addkernels + " -target " + target.string() + " -depfile " +
+                             depfile.string() + " -cache " + cache_dir.string() + " -source " +
+                             valid_src.string());
+        };
+        const auto first  = test_srcs.path / "first.hpp";
+        const auto second = test_srcs.path / "second.hpp";
+        EXPECT_EQUAL(0, run_cached(first));
+        EXPECT_EQUAL(0, run_cached(second));
+        EXPECT(ReadAll(first) == ReadAll(second));
+        EXPECT(ReadAll(depfile).find(header_filename) != std::string::npos);
+        EXPECT(!bf::is_empty(cache_dir));
     }
 };
 
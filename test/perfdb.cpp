@@ -29,6 +29,7 @@
 
 #include <miopen/db.hpp>
 #include <miopen/db_record.hpp>
+#include <miopen/db_write_queue.hpp>
 #include <miopen/lock_file.hpp>
 #include <miopen/temp_file.hpp>
 
@@ -417,6 +418,59 @@ class DbWriteTest : public DbTest
     }
 };
 
+class DbWriteBehindTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing db with deferred writes..." << std::endl;
+
+        ResetDb();
+        RawWrite(temp_file, key(), common_data());
+        const TestData other_key(10, 20);
+        const TestData removed_key(30, 40);
+        testing_db_write_behind = true;
+
+        {
+            PlainTextDb db(temp_file);
+
+            EXPECT(db.Update(removed_key, id0(), value0()));
+            EXPECT(db.Update(other_key, id0(), value1()));
+            EXPECT(db.Update(other_key, id0(), value0()));
+            EXPECT(db.Update(other_key, id1(), value1()));
+            EXPECT(db.Update(key(), id2(), value2()));
+            EXPECT(db.Remove(key(), id0()));
+            EXPECT(!db.Remove(key(), missing_id()));
+            EXPECT(db.RemoveRecord(removed_key));
+
+            // Read-your-writes regardless of whether the queue has been flushed already.
+            ValidateSingleEntry(other_key, common_data(), db);
+            EXPECT(!db.FindRecord(removed_key));
+
+            TestData read;
+            EXPECT(!db.Load(key(), id0(), read));
+            EXPECT(db.Load(key(), id2(), read));
+            EXPECT_EQUAL(value2(), read);
+        }
+
+        DbWriteQueue::FlushAll();
+        testing_db_write_behind = false;
+
+        PlainTextDb db(temp_file);
+        ValidateSingleEntry(other_key, common_data(), db);
+        EXPECT(!db.FindRecord(removed_key));
+
+        const auto record = db.FindRecord(key());
+        EXPECT(record);
+        TestData read;
+        EXPECT(!record->GetValues(id0(), read));
+        EXPECT(record->GetValues(id1(), read));
+        EXPECT_EQUAL(value1(), read);
+        EXPECT(record->GetValues(id2(), read));
+        EXPECT_EQUAL(value2(), read);
+    }
+};
+
 class DbOperationsTest : public DbTest
 {
     public:
@@ -1312,6 +1366,7 @@ struct PerfDbDriver : test_driver
         DbWriteTest().Run();
         DbOperationsTest().Run();
         DbParallelTest().Run();
+        DbWriteBehindTest().Run();
 
         DbMultiThreadedReadTest().Run();
         DbMultiProcessReadTest().Run();